@@ -11,6 +11,7 @@
 #include "impala/emit.h"
 #include "impala/parser.h"
 #include "impala/print.h"
+#include "impala/source.h"
 
 #ifndef NDEBUG
 #define LOG_LEVELS "error|warn|info|verbose|debug"
@@ -148,8 +149,8 @@ int main(int argc, char** argv) {
             thorin::outln("at the moment there is only one input file supported");
 
         auto filename = infiles.front().c_str();
-        std::ifstream file(filename, std::ios::binary);
-        auto prg = impala::parse(compiler, file, filename);
+        impala::Source source(filename);
+        auto prg = impala::parse(compiler, source.contents(), filename);
         impala::Scopes scopes(compiler);
         prg->bind(scopes);
 
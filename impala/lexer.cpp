@@ -1,7 +1,14 @@
 #include "impala/lexer.h"
 
+#include <iterator>
 #include <stdexcept>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace impala {
 
 // character classes
@@ -16,15 +23,23 @@ inline bool sgn(uint32_t c) { return c == '+' || c == '-'; }
 
 Lexer::Lexer(Compiler& compiler, std::istream& is, const char* filename)
     : compiler(compiler)
-    , stream_(is)
     , filename_(filename)
 {
-    size_t i = 0;
-#define CODE(tag, str) keywords_[i++] = {Symbol(str), TT::tag};
-    IMPALA_KEYWORDS(CODE)
-#undef CODE
+    if (!is) throw std::runtime_error("stream is bad");
+    buffer_.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    init(buffer_);
+}
 
-    if (!stream_) throw std::runtime_error("stream is bad");
+Lexer::Lexer(Compiler& compiler, std::string_view buffer, const char* filename)
+    : compiler(compiler)
+    , filename_(filename)
+{
+    init(buffer);
+}
+
+void Lexer::init(std::string_view buffer) {
+    ptr_ = buffer.data();
+    end_ = buffer.data() + buffer.size();
     next();
     accept(0xfeff, false); // eat utf-8 BOM if present
     front_line_ = front_col_  = 1;
@@ -32,26 +47,98 @@ Lexer::Lexer(Compiler& compiler, std::istream& is, const char* filename)
     peek_line_  = peek_col_   = 1;
 }
 
+/*
+ * keywords
+ *
+ * Keywords are classified via a perfect hash which is generated at compile time from IMPALA_KEYWORDS.
+ * This way, keywords never touch the symbol table.
+ */
+
+namespace {
+
+struct Keyword {
+    std::string_view str;
+    TT tag = TT::M_id;
+};
+
+constexpr std::array<Keyword, Num_Keywords> keywords = {{
+#define CODE(tag, str) {str, TT::tag},
+    IMPALA_KEYWORDS(CODE)
+#undef CODE
+}};
+
+constexpr uint32_t Keyword_Table_Bits = 6;
+constexpr size_t Keyword_Table_Size = 1_s << Keyword_Table_Bits;
+static_assert(Num_Keywords <= Keyword_Table_Size);
+
+constexpr uint32_t keyword_hash(std::string_view s, uint32_t seed) {
+    uint32_t hash = seed; // FNV-1a
+    for (auto c : s)
+        hash = (hash ^ uint32_t((unsigned char) c)) * 16777619_u32;
+    return hash >> (32_u32 - Keyword_Table_Bits); // the upper bits depend on all input bits
+}
+
+constexpr bool is_perfect(uint32_t seed) {
+    std::array<bool, Keyword_Table_Size> used = {};
+    for (auto&& keyword : keywords) {
+        auto hash = keyword_hash(keyword.str, seed);
+        if (used[hash]) return false;
+        used[hash] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t find_keyword_seed() {
+    uint32_t seed = 2166136261_u32;
+    while (!is_perfect(seed)) ++seed;
+    return seed;
+}
+
+constexpr uint32_t Keyword_Seed = find_keyword_seed();
+
+constexpr std::array<Keyword, Keyword_Table_Size> make_keyword_table() {
+    std::array<Keyword, Keyword_Table_Size> table = {};
+    for (auto&& keyword : keywords)
+        table[keyword_hash(keyword.str, Keyword_Seed)] = keyword;
+    return table;
+}
+
+constexpr auto keyword_table = make_keyword_table();
+
+/// Yields the corresponding keyword tag or @c TT::M_id if @p s is not a keyword.
+inline TT keyword(std::string_view s) {
+    auto&& keyword = keyword_table[keyword_hash(s, Keyword_Seed)];
+    return keyword.str == s ? keyword.tag : TT::M_id;
+}
+
+}
+
 inline bool is_bit_set(uint32_t val, uint32_t n) { return bool((val >> n) & 1_u32); }
 inline bool is_bit_clear(uint32_t val, uint32_t n) { return !is_bit_set(val, n); }
 
 // see https://en.wikipedia.org/wiki/UTF-8
 uint32_t Lexer::next() {
     uint32_t result = peek_;
-    uint32_t b1 = stream_.get();
     std::fill(peek_bytes_, peek_bytes_ + 4, 0);
-    peek_bytes_[0] = b1;
 
-    if (b1 == (uint32_t) std::istream::traits_type::eof()) {
+    if (ptr_ == end_) {
         back_line_ = peek_line_;
         back_col_  = peek_col_;
-        peek_ = b1;
+        peek_ = Eof;
         return result;
     }
 
+    uint32_t b1 = (unsigned char) *ptr_++;
+    peek_bytes_[0] = b1;
+
     int n_bytes = 1;
+    bool truncated = false;
     auto get_next_utf8_byte = [&] () {
-        uint32_t b = stream_.get();
+        uint32_t b = 0xff_u32;
+        if (ptr_ != end_)
+            b = (unsigned char) *ptr_++;
+        else
+            truncated = true;
         peek_bytes_[n_bytes++] = b;
         if (is_bit_clear(b, 7) || is_bit_set(b, 6))
             error("invalid utf-8 character");
@@ -62,7 +149,7 @@ uint32_t Lexer::next() {
         back_line_ = peek_line_;
         back_col_  = peek_col_;
         ++peek_col_;
-        peek_ = peek;
+        peek_ = truncated ? Eof : peek; // a truncated sequence ends the input
         return result;
     };
 
@@ -102,9 +189,128 @@ uint32_t Lexer::next() {
     return 0;
 }
 
+/*
+ * fast skipping of whitespace and comments
+ *
+ * The scanners below consume plain ASCII only and stop at the first byte >= 0x80.
+ * Multi-byte characters still go through next() which validates them.
+ */
+
+namespace {
+
+/// Result of scan: the first byte we stop at and the newlines that were passed on the way there.
+struct Scan {
+    const char* stop;
+    uint32_t num_newlines = 0;
+    const char* last_newline = nullptr;
+};
+
+#if defined(__AVX2__)
+using Vec = __m256i;
+constexpr size_t Vec_Size = 32;
+inline Vec load(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const Vec*>(p)); }
+inline Vec splat(char c) { return _mm256_set1_epi8(c); }
+inline Vec eq(Vec v, char c) { return _mm256_cmpeq_epi8(v, splat(c)); }
+inline Vec in_range(Vec v, char lo, char hi) { auto d = _mm256_sub_epi8(v, splat(lo)); return _mm256_cmpeq_epi8(_mm256_min_epu8(d, splat(hi - lo)), d); }
+inline Vec either(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+inline uint32_t mask(Vec v) { return uint32_t(_mm256_movemask_epi8(v)); }
+#elif defined(__SSE2__)
+using Vec = __m128i;
+constexpr size_t Vec_Size = 16;
+inline Vec load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const Vec*>(p)); }
+inline Vec splat(char c) { return _mm_set1_epi8(c); }
+inline Vec eq(Vec v, char c) { return _mm_cmpeq_epi8(v, splat(c)); }
+inline Vec in_range(Vec v, char lo, char hi) { auto d = _mm_sub_epi8(v, splat(lo)); return _mm_cmpeq_epi8(_mm_min_epu8(d, splat(hi - lo)), d); }
+inline Vec either(Vec a, Vec b) { return _mm_or_si128(a, b); }
+inline uint32_t mask(Vec v) { return uint32_t(_mm_movemask_epi8(v)); }
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+constexpr uint32_t Full_Mask = uint32_t((1_u64 << Vec_Size) - 1_u64);
+#define IMPALA_SIMD_SCAN
+#endif
+
+inline bool ascii(unsigned char c) { return c < 0x80; }
+
+/// Stops at anything but whitespace.
+struct Wsp {
+    static bool stop(unsigned char c) { return !wsp(c); }
+#ifdef IMPALA_SIMD_SCAN
+    static uint32_t stop(Vec v) { return ~mask(either(eq(v, ' '), in_range(v, '\t', '\r'))) & Full_Mask; }
+#endif
+};
+
+/// Stops at the end of a line comment.
+struct Line {
+    static bool stop(unsigned char c) { return c == '\n' || !ascii(c); }
+#ifdef IMPALA_SIMD_SCAN
+    static uint32_t stop(Vec v) { return mask(eq(v, '\n')) | mask(v); }
+#endif
+};
+
+/// Stops at a potential end of a multiline comment.
+struct Block {
+    static bool stop(unsigned char c) { return c == '*' || !ascii(c); }
+#ifdef IMPALA_SIMD_SCAN
+    static uint32_t stop(Vec v) { return mask(eq(v, '*')) | mask(v); }
+#endif
+};
+
+template<class Pred>
+Scan scan(const char* p, const char* end) {
+    Scan s;
+#ifdef IMPALA_SIMD_SCAN
+    auto count_newlines = [&](const char* block, uint32_t newlines) {
+        if (newlines != 0) {
+            s.num_newlines += __builtin_popcount(newlines);
+            s.last_newline = block + 31 - __builtin_clz(newlines);
+        }
+    };
+
+    for (; size_t(end - p) >= Vec_Size; p += Vec_Size) {
+        auto v = load(p);
+        auto newlines = mask(eq(v, '\n'));
+        if (auto stop = Pred::stop(v)) {
+            auto i = __builtin_ctz(stop);
+            count_newlines(p, newlines & ((1_u32 << i) - 1_u32));
+            s.stop = p + i;
+            return s;
+        }
+        count_newlines(p, newlines);
+    }
+#endif
+    for (; p != end && !Pred::stop(*p); ++p) {
+        if (*p == '\n') {
+            ++s.num_newlines;
+            s.last_newline = p;
+        }
+    }
+    s.stop = p;
+    return s;
+}
+
+}
+
+/// Consumes the current character and all following ones up to the first one @p Pred stops at.
+template<class Pred>
+void Lexer::skip() {
+    auto s = scan<Pred>(ptr_, end_);
+    if (s.stop != ptr_) {
+        // move peek_line_/peek_col_ to the last skipped character; next() will then advance to s.stop
+        if (s.num_newlines == 0) {
+            peek_col_ += uint32_t(s.stop - ptr_);
+        } else {
+            peek_line_ += s.num_newlines;
+            peek_col_ = uint32_t(s.stop - 1 - s.last_newline);
+        }
+        ptr_ = s.stop;
+    }
+    next();
+}
+
 void Lexer::eat_comments() {
     while (true) {
-        while (!eof() && peek() != '*') next();
+        while (!eof() && peek() != '*') skip<Block>();
         if (eof()) {
             error("non-terminated multiline comment");
             return;
@@ -124,8 +330,8 @@ Token Lexer::lex() {
         if (eof()) return {loc(), TT::M_eof};
 
         // skip whitespace
-        if (accept_if(wsp, false)) {
-            while (accept_if(wsp, false)) {}
+        if (wsp(peek())) {
+            skip<Wsp>();
             continue;
         }
 
@@ -200,7 +406,7 @@ Token Lexer::lex() {
             // Handle comments here
             if (accept('*')) { eat_comments(); continue; }
             if (accept('/')) {
-                while (!eof() && peek() != '\n') next();
+                while (!eof() && peek() != '\n') skip<Line>();
                 continue;
             }
             if (accept('='))  return {loc(), TT::O_div_assign};
@@ -234,9 +440,8 @@ Token Lexer::lex() {
         // identifier
         if (accept_if(sym)) {
             while (accept_if(sym) || accept_if(dec)) {}
-            Symbol symbol(str_);
-            auto i = std::find_if(keywords_.begin(), keywords_.end(), [&](auto p) { return p.first == symbol; });
-            return i == keywords_.end() ? Token{loc(), symbol} : Token{loc(), i->second};
+            if (auto tag = keyword(str_); tag != TT::M_id) return {loc(), tag};
+            return {loc(), Symbol(str_)};
         }
 
         // utf-8
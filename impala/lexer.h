@@ -1,6 +1,8 @@
 #ifndef IMPALA_LEXER_H
 #define IMPALA_LEXER_H
 
+#include <string_view>
+
 #include "impala/compiler.h"
 
 #include "thorin/util/debug.h"
@@ -11,15 +13,22 @@ namespace impala {
 
 class Lexer {
 public:
+    /// Reads the whole @p std::istream into an internal buffer; use this for pipes and the like.
     Lexer(Compiler& compiler, std::istream&, const char* filename);
+    /// Lexes directly from @p buffer which must outlive this @p Lexer.
+    Lexer(Compiler& compiler, std::string_view buffer, const char* filename);
 
     Token lex(); ///< Get next \p Token in stream.
 
     Compiler& compiler;
 
 private:
-    bool eof() const { return stream_.eof(); }
+    static constexpr uint32_t Eof = uint32_t(-1);
+
+    void init(std::string_view);
+    bool eof() const { return peek_ == Eof; }
     void eat_comments();
+    template<class Pred> void skip();
     Token parse_literal();
 
     template <typename Pred>
@@ -57,7 +66,9 @@ private:
     template<class... Args>
     std::ostream& error(const char* fmt, Args... args) { return compiler.error(loc(), fmt, std::forward<Args>(args)...); }
 
-    std::istream& stream_;
+    std::string buffer_; ///< only used when reading from a std::istream
+    const char* ptr_ = nullptr;
+    const char* end_ = nullptr;
     uint32_t peek_ = 0;
     char peek_bytes_[5] = {0, 0, 0, 0, 0};
     const char* filename_;
@@ -65,7 +76,6 @@ private:
     uint32_t front_line_, front_col_;
     uint32_t  back_line_,  back_col_;
     uint32_t  peek_line_,  peek_col_;
-    std::array<std::pair<Symbol, TT>, Num_Keywords> keywords_;
 };
 
 }
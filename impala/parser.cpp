@@ -11,6 +11,13 @@ Parser::Parser(Compiler& compiler, std::istream& stream, const char* filename)
     prev_ = Loc(filename, 1, 1, 1, 1);
 }
 
+Parser::Parser(Compiler& compiler, std::string_view buffer, const char* filename)
+    : lexer_(compiler, buffer, filename)
+{
+    for (int i = 0; i != max_ahead; ++i) lex();
+    prev_ = Loc(filename, 1, 1, 1, 1);
+}
+
 /*
  * helpers
  */
@@ -542,6 +549,11 @@ Ptr<Expr> parse_expr(Compiler& compiler, std::istream& is, const char* filename)
     return parser.parse_expr("global expression");
 }
 
+Ptr<Expr> parse_expr(Compiler& compiler, std::string_view buffer, const char* filename) {
+    Parser parser(compiler, buffer, filename);
+    return parser.parse_expr("global expression");
+}
+
 Ptr<Expr> parse_expr(Compiler& compiler, const char* str) {
     std::istringstream in(str);
     return parse_expr(compiler, in, "<inline>");
@@ -552,6 +564,11 @@ Ptr<Prg> parse(Compiler& compiler, std::istream& is, const char* filename) {
     return parser.parse_prg();
 }
 
+Ptr<Prg> parse(Compiler& compiler, std::string_view buffer, const char* filename) {
+    Parser parser(compiler, buffer, filename);
+    return parser.parse_prg();
+}
+
 Ptr<Prg> parse(Compiler& compiler, const char* str) {
     std::istringstream in(str);
     return parse(compiler, in, "<inline>");
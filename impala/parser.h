@@ -28,6 +28,7 @@ private:
 
 public:
     Parser(Compiler&, std::istream&, const char* filename);
+    Parser(Compiler&, std::string_view buffer, const char* filename);
 
     Compiler& compiler() { return lexer_.compiler; }
 
@@ -168,8 +169,10 @@ private:
 };
 
 Ptr<Expr> parse_expr(Compiler&, std::istream& is, const char* filename);
+Ptr<Expr> parse_expr(Compiler&, std::string_view buffer, const char* filename);
 Ptr<Expr> parse_expr(Compiler&, const char*);
 Ptr<Prg> parse(Compiler&, std::istream& is, const char* filename);
+Ptr<Prg> parse(Compiler&, std::string_view buffer, const char* filename);
 Ptr<Prg> parse(Compiler&, const char*);
 
 }
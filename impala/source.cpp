@@ -0,0 +1,69 @@
+#include "impala/source.h"
+
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define IMPALA_HAS_MMAP
+#endif
+
+namespace impala {
+
+Source::Source(const char* filename)
+    : filename_(filename)
+{
+#ifdef IMPALA_HAS_MMAP
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) throw std::runtime_error(std::string("cannot open '") + filename + "'");
+
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        if (st.st_size == 0) {
+            ::close(fd);
+            return;
+        }
+
+        auto size = size_t(st.st_size);
+        auto map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            ::madvise(map, size, MADV_SEQUENTIAL);
+            ::close(fd);
+            map_ = map;
+            map_size_ = size;
+            contents_ = std::string_view(static_cast<const char*>(map), size);
+            return;
+        }
+    }
+    ::close(fd);
+#endif
+
+    // fall back to reading the whole file
+    std::ifstream ifs(filename, std::ios::binary);
+    if (!ifs) throw std::runtime_error(std::string("cannot open '") + filename + "'");
+    read(ifs);
+}
+
+Source::Source(std::istream& is, const char* filename)
+    : filename_(filename)
+{
+    if (!is) throw std::runtime_error("stream is bad");
+    read(is);
+}
+
+Source::~Source() {
+#ifdef IMPALA_HAS_MMAP
+    if (map_ != nullptr) ::munmap(map_, map_size_);
+#endif
+}
+
+void Source::read(std::istream& is) {
+    buffer_.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+    contents_ = buffer_;
+}
+
+}
@@ -0,0 +1,35 @@
+#ifndef IMPALA_SOURCE_H
+#define IMPALA_SOURCE_H
+
+#include <istream>
+#include <string>
+#include <string_view>
+
+namespace impala {
+
+/// The contents of an input file.
+/// Regular files are mapped into memory via @c mmap; everything else (pipes, ...) is read into a buffer.
+class Source {
+public:
+    Source(const Source&) = delete;
+    Source& operator=(const Source&) = delete;
+    explicit Source(const char* filename);
+    Source(std::istream&, const char* filename);
+    ~Source();
+
+    const char* filename() const { return filename_; }
+    std::string_view contents() const { return contents_; }
+
+private:
+    void read(std::istream&);
+
+    const char* filename_;
+    std::string buffer_;        ///< used if we cannot map the file
+    void* map_ = nullptr;
+    size_t map_size_ = 0;
+    std::string_view contents_;
+};
+
+}
+
+#endif
@@ -62,6 +62,37 @@ TEST(Lexer, LocId) {
     EXPECT_EQ(t7.loc(), Loc("stdin", 2, 14, 2, 14));
 }
 
+TEST(Lexer, Buffer) {
+    static const char* in = "fn f(a: int) -> int {\n    a += 0x2a; // answer\n    /* «‹ */ a\n}\n";
+    Compiler compiler;
+    std::istringstream is(in);
+    Lexer stream_lexer(compiler, is, "stdin");
+    Lexer buffer_lexer(compiler, std::string_view(in), "stdin");
+
+    while (true) {
+        auto t1 = stream_lexer.lex();
+        auto t2 = buffer_lexer.lex();
+        EXPECT_EQ(t1.tag(), t2.tag());
+        EXPECT_EQ(t1.loc(), t2.loc());
+        if (t1.isa(Token::Tag::M_eof) || t2.isa(Token::Tag::M_eof)) break;
+    }
+    EXPECT_EQ(compiler.num_errors(), 0);
+}
+
+TEST(Lexer, Keywords) {
+    Compiler compiler;
+    std::istringstream is("ar arity Arity Cn cn else false fn Fn for if impl let marity Marity match mut pk qualifier Qualifier struct true trait type while "
+                          "a arr Ar fnn iff whilE types");
+    Lexer lexer(compiler, is, "stdin");
+
+#define CODE(t, str) EXPECT_TRUE(lexer.lex().isa(Token::Tag::t));
+    IMPALA_KEYWORDS(CODE)
+#undef CODE
+    for (int i = 0; i != 7; ++i)
+        EXPECT_TRUE(lexer.lex().isa(Token::Tag::M_id));
+    EXPECT_TRUE(lexer.lex().isa(Token::Tag::M_eof));
+}
+
 TEST(Lexer, Literals) {
 }
 